@@ -0,0 +1,186 @@
+// The k-core of a graph is its maximal subgraph in which every vertex has degree at least k.
+// Coreness of a vertex is the largest k such that the vertex belongs to the k-core.
+// This file contains a parallel bucket-based peeling algorithm to compute coreness of all vertices.
+//
+// Copyright (c) 2014, 2015 savrus
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "graph.hpp"
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <omp.h>
+
+namespace hl {
+
+// K-core decomposition by parallel peeling.
+// Arc directions are ignored: degree of v is the number of its neighbours, self-loops excluded.
+// Vertices are peeled level by level. The bucket of level k holds the remaining vertices with degree at most k.
+// All vertices of the bucket are removed in parallel, and neighbours whose degree drops to k join the bucket.
+// Small buckets are peeled by a single thread since chain-like parts of a graph need many tiny rounds.
+class KCore {
+    static const size_t parallel_threshold = 4096;  // minimum number of vertices to process in parallel
+
+    Graph &g;                                 // Graph
+    Vertex n;                                 // Number of vertices
+    std::vector<int> degree;                  // degree[v] is the current degree of v in the remaining graph
+    std::vector<int> core;                    // core[v] is the coreness of v (-1 if v is not peeled yet)
+    std::vector<Vertex> remaining;            // vertices not peeled before the current level (compacted lazily)
+    std::vector<Vertex> bucket;               // vertices to peel in the current round
+    std::vector<Vertex> next;                 // vertices to peel in the next round of the same level
+    int max_core;                             // maximum coreness
+
+    // Compare arc by head
+    struct cmp_by_head {
+        bool operator() (const Arc &a, Vertex u) const { return a.head < u; }
+    };
+
+    // Check arc direction
+    struct is_reverse { bool operator() (const Arc &a) const { return a.reverse; } };
+    struct is_reverse_only { bool operator() (const Arc &a) const { return !a.forward; } };
+
+    // Check whether a range of arcs sorted by head contains an arc to u
+    static bool has_head(Graph::arc_iterator begin, Graph::arc_iterator end, Vertex u) {
+        Graph::arc_iterator a = std::lower_bound(begin, end, u, cmp_by_head());
+        return a < end && a->head == u;
+    }
+
+    // Check whether the arc is a self-loop or repeats the head of the previous arc in its group
+    static bool is_redundant(Vertex v, Graph::arc_iterator begin, Graph::arc_iterator a) {
+        return a->head == v || (a > begin && (a-1)->head == a->head);
+    }
+
+    // Get list of v's neighbours, each neighbour once.
+    // Adjacency lists consist of three groups sorted by head: incoming-only arcs, bidirectional arcs, and outgoing-only arcs.
+    // Arcs to the same neighbour with different lengths are not merged, so a neighbour may appear in several groups.
+    void get_neighbours(Vertex v, std::vector<Vertex> &neighbours) const {
+        Graph::arc_iterator in = g.begin(v, false), in_end = g.end(v, false);
+        Graph::arc_iterator both = g.begin(v, true), out_end = g.end(v, true);
+        Graph::arc_iterator both_end = std::partition_point(both, out_end, is_reverse());
+        in_end = std::partition_point(in, in_end, is_reverse_only());
+        neighbours.clear();
+        for (Graph::arc_iterator a = both; a < both_end; ++a) {
+            if (!is_redundant(v, both, a)) neighbours.push_back(a->head);
+        }
+        for (Graph::arc_iterator a = both_end; a < out_end; ++a) {
+            if (!is_redundant(v, both_end, a) && !has_head(both, both_end, a->head)) neighbours.push_back(a->head);
+        }
+        for (Graph::arc_iterator a = in; a < in_end; ++a) {
+            if (!is_redundant(v, in, a) && !has_head(both, both_end, a->head) && !has_head(both_end, out_end, a->head)) neighbours.push_back(a->head);
+        }
+    }
+
+    // Append thread-local list of vertices to the shared one
+    static void merge(std::vector<Vertex> &to, std::vector<Vertex> &from) {
+        #pragma omp critical
+        to.insert(to.end(), from.begin(), from.end());
+        from.clear();
+    }
+
+    // Move remaining vertices with degree at most k into the bucket and drop already peeled ones
+    void fill_bucket(int k) {
+        #pragma omp parallel if (remaining.size() >= parallel_threshold)
+        {
+            std::vector<Vertex> local_bucket, local_remaining;
+            #pragma omp for nowait
+            for (size_t i = 0; i < remaining.size(); ++i) {
+                Vertex v = remaining[i];
+                if (core[v] >= 0) continue;
+                if (degree[v] <= k) local_bucket.push_back(v);
+                else local_remaining.push_back(v);
+            }
+            merge(bucket, local_bucket);
+            merge(next, local_remaining);
+        }
+        remaining.swap(next);
+        next.clear();
+    }
+
+    // Decrease degree of u after its neighbour is peeled at level k
+    void decrease(Vertex u, int k, std::vector<Vertex> &local) {
+        int d;
+        #pragma omp atomic read
+        d = degree[u];
+        if (d <= k) return;
+        #pragma omp atomic capture
+        d = degree[u]--;
+        // Exactly one thread sees the degree passing from k+1 to k
+        if (d == k + 1) local.push_back(u);
+    }
+
+    // Peel all vertices in the bucket at level k
+    void peel(int k) {
+        #pragma omp parallel if (bucket.size() >= parallel_threshold)
+        {
+            std::vector<Vertex> local, neighbours;
+            #pragma omp for schedule(dynamic, 64)
+            for (size_t i = 0; i < bucket.size(); ++i) {
+                Vertex v = bucket[i];
+                core[v] = k;
+                get_neighbours(v, neighbours);
+                for (size_t j = 0; j < neighbours.size(); ++j) decrease(neighbours[j], k, local);
+            }
+            merge(next, local);
+        }
+        bucket.swap(next);
+        next.clear();
+    }
+
+public:
+    KCore(Graph &g) : g(g), n(g.get_n()), degree(n), core(n), max_core(0) {}
+
+    int get_core(Vertex v) const { return core[v]; }   // Coreness of v
+    int get_max() const { return max_core; }           // Maximum coreness
+
+    // Compute coreness of all vertices
+    void run() {
+        remaining.resize(n);
+        #pragma omp parallel
+        {
+            std::vector<Vertex> neighbours;
+            #pragma omp for
+            for (Vertex v = 0; v < n; ++v) {
+                get_neighbours(v, neighbours);
+                degree[v] = neighbours.size();
+                core[v] = -1;
+                remaining[v] = v;
+            }
+        }
+        max_core = 0;
+        for (int k = 0; !remaining.empty(); ++k) {
+            // Skip empty levels
+            int min_degree = std::numeric_limits<int>::max();
+            #pragma omp parallel for reduction(min:min_degree) if (remaining.size() >= parallel_threshold)
+            for (size_t i = 0; i < remaining.size(); ++i) {
+                Vertex v = remaining[i];
+                if (core[v] < 0 && degree[v] < min_degree) min_degree = degree[v];
+            }
+            if (min_degree == std::numeric_limits<int>::max()) break;
+            if (min_degree > k) k = min_degree;
+            max_core = k;
+            fill_bucket(k);
+            while (!bucket.empty()) peel(k);
+        }
+    }
+};
+
+}
@@ -0,0 +1,114 @@
+// This file contains a program to order vertices by their coreness (k-core decomposition).
+//
+// Copyright (c) 2014, 2015 savrus
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "graph.hpp"
+#include "kcore.hpp"
+#include "ordering.hpp"
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <random>
+#include <iostream>
+#include <cstdlib>
+#include <cassert>
+#include <omp.h>
+#include <string.h>
+
+using namespace hl;
+
+void usage(char *argv[]) {
+    std::cout << "Usage: " << argv[0] << " [-r seed] [-t threads] -o ordering graph" << std::endl
+              << "  -o ordering\tFile to write the vertex order" << std::endl
+              << "  -r seed    \tBreak ties at random instead of by degree" << std::endl
+              << "  -t threads \tNumber of threads" << std::endl;
+    std::exit(1);
+}
+
+// Vertex sort key: coreness first, then tie-breaker, then vertex ID
+struct Key {
+    int core;
+    size_t tie;
+    Vertex v;
+    bool operator< (const Key &x) const {
+        if (core != x.core) return core > x.core;
+        if (tie != x.tie) return tie > x.tie;
+        return v < x.v;
+    }
+};
+
+int main(int argc, char *argv[]) {
+    char *graph_file = NULL;
+    char *order_file = NULL;
+    int num_threads = omp_get_max_threads();
+    bool is_random = false;
+    unsigned long seed = 0;
+    int argi;
+    for (argi = 1; argi < argc; ++argi) {
+        if (argv[argi][0] == '-') {
+            if (!strcmp("--", argv[argi])) { ++argi; break; }
+            else if (!strcmp("-h", argv[argi])) usage(argv);
+            else if (!strcmp("-o", argv[argi])) { if (++argi >= argc) usage(argv); order_file = argv[argi]; }
+            else if (!strcmp("-r", argv[argi])) { if (++argi >= argc) usage(argv); seed = strtoul(argv[argi], NULL, 10); is_random = true; }
+            else if (!strcmp("-t", argv[argi])) { if (++argi >= argc) usage(argv); num_threads = strtoul(argv[argi], NULL, 10); }
+            else usage(argv);
+        } else if (graph_file == NULL) graph_file = argv[argi];
+        else break;
+    }
+    if (argi != argc || !graph_file || !order_file) usage(argv);
+    assert(num_threads > 0);
+    omp_set_num_threads(num_threads);
+
+    Graph g;
+    if (!g.read(graph_file)) {
+        std::cerr << "Unable to read graph from file " << graph_file << std::endl;
+        std::exit(1);
+    }
+    std::cout << "Graph has " << g.get_n() << " vertices and " << g.get_m() << " arcs" << std::endl;
+
+    KCore kcore(g);
+    kcore.run();
+    std::cout << "Maximum coreness " << kcore.get_max() << std::endl;
+
+    std::vector<Vertex> order(g.get_n());
+    std::vector<Key> d(g.get_n());
+
+    // Random tie-breaker is a position in a random permutation.
+    // Use explicit Fisher-Yates shuffle since std::shuffle is implementation-defined, so the order depends on the seed only.
+    std::vector<Vertex> perm;
+    if (is_random) {
+        std::mt19937_64 rnd(seed);
+        perm.resize(g.get_n());
+        for (Vertex v = 0; v < g.get_n(); ++v) perm[v] = v;
+        for (Vertex i = g.get_n(); i > 1; --i) std::swap(perm[i-1], perm[rnd() % i]);
+    }
+
+    #pragma omp parallel for
+    for (Vertex v = 0; v < g.get_n(); ++v) {
+        d[v].core = kcore.get_core(v);
+        d[v].tie = is_random ? perm[v] : g.get_degree(v);
+        d[v].v = v;
+    }
+    std::sort(d.begin(), d.end());
+    for (size_t i = 0; i < d.size(); ++i) order[i] = d[i].v;
+
+    if (order_file && (!Order::write(order_file, order))) std::cerr << "Unable to write order to file " << order_file << std::endl;
+}